@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h> // Απαραίτητο για τα μηνύματα σφάλματος του προσωρινού αρχείου
+#include <stdint.h> // Απαραίτητο για uint32_t/uint64_t του codec SWLC
 #include <math.h> // Απαραίτητο για trunc() και sin()
 
 // Ορισμός της σταθεράς PI αν δεν είναι ήδη ορισμένη
@@ -8,28 +10,124 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-// Παγκόσμιος μετρητής bytes που έχουν διαβαστεί από το stdin.
-// Απαραίτητος για τον έλεγχο 'bad file size' στην εντολή info και για τη χρήση
-// μόνο της getchar() (μοναδικός τρόπος μέτρησης θέσης).
+// Παγκόσμιος μετρητής bytes που έχουν διαβαστεί από την είσοδο.
+// Απαραίτητος για τον έλεγχο 'bad file size' στην εντολή info. Όλα τα bytes
+// εισόδου περνούν από την read_raw_byte() (getc(input_stream)) ή, σε τμήματα,
+// από την read_bytes_safe() (fread(input_stream)). Η input_stream είναι το
+// stdin ή, για pipe στη normalize, το προσωρινό αρχείο όπου η
+// spill_input_to_tmpfile() έχει αντιγράψει το stdin.
+// Σε συμπιεσμένη είσοδο μετράει τα αποκωδικοποιημένα bytes (ισοδύναμο WAV).
 static long total_bytes_read = 0;
 
+// Σημαίες μορφής εισόδου/εξόδου (βλ. ενότητα SWLC παρακάτω).
+static int output_is_lossless = 0; // Ορίζεται από την επιλογή --lossless
+static int input_is_lossless = 0;  // Ανιχνεύεται από το magic "SWLC" της εισόδου
+static int input_probed = 0;
+
+// Ροή εισόδου: το stdin ή, για μη αναζητήσιμη είσοδο της normalize,
+// ένα προσωρινό αρχείο με αντίγραφό του.
+static FILE *input_stream = NULL;
+
+// Bytes που διαβάστηκαν κατά την ανίχνευση και δεν ήταν "SWLC".
+static unsigned char probe_bytes[4];
+static int probe_len = 0;
+static int probe_pos = 0;
+
+// Σημεία εισόδου του codec SWLC (ορίζονται παρακάτω).
+void lossless_probe_input();
+int lossless_read_byte();
+size_t lossless_read_bytes(unsigned char *dst, size_t len);
+void lossless_write_byte(int byte);
+void lossless_finish();
+void lossless_reset_input();
+
 // ------------------------------------------------
 // Βοηθητικές Συναρτήσεις για Ανάγνωση/Εγγραφή (Little-Endian)
 // ------------------------------------------------
 
 /**
- * Διαβάζει ένα byte από το stdin και ενημερώνει τον συνολικό μετρητή.
- * Η ΜΟΝΗ συνάρτηση που καλεί την getchar().
+ * Διαβάζει ένα ακατέργαστο byte από τη ροή εισόδου (stdin ή προσωρινό αρχείο).
+ * Η ΜΟΝΗ συνάρτηση που διαβάζει μεμονωμένα bytes εισόδου (getc()).
+ * @return Το byte ως int (ή EOF).
+ */
+int read_raw_byte() {
+    return getc(input_stream);
+}
+
+/**
+ * Διαβάζει ένα byte της εισόδου WAV και ενημερώνει τον συνολικό μετρητή.
+ * Αν η είσοδος είναι σε μορφή SWLC, επιστρέφει τα αποκωδικοποιημένα bytes.
  * @return Το byte ως int (ή EOF).
  */
 int read_byte_safe() {
-    int byte = getchar();
+    int byte;
+    if (!input_probed) {
+        lossless_probe_input();
+    }
+
+    if (input_is_lossless) {
+        byte = lossless_read_byte();
+    } else if (probe_pos < probe_len) {
+        byte = probe_bytes[probe_pos++];
+    } else {
+        byte = read_raw_byte();
+    }
+
     if (byte != EOF) {
         total_bytes_read++; // Αύξηση του μετρητή
     }
     return byte;
 }
 
+/**
+ * Διαβάζει έως len bytes της εισόδου WAV στο dst σε ένα βήμα, αντί για ένα
+ * byte τη φορά. Ενημερώνει τον μετρητή όπως η read_byte_safe().
+ * @return Πλήθος bytes που διαβάστηκαν (λιγότερα από len μόνο στο EOF).
+ */
+size_t read_bytes_safe(unsigned char *dst, size_t len) {
+    size_t n = 0;
+    if (!input_probed) {
+        lossless_probe_input();
+    }
+
+    if (input_is_lossless) {
+        n = lossless_read_bytes(dst, len);
+    } else {
+        while (n < len && probe_pos < probe_len) {
+            dst[n++] = probe_bytes[probe_pos++];
+        }
+        n += fread(dst + n, 1, len - n, input_stream);
+    }
+
+    total_bytes_read += (long)n;
+    return n;
+}
+
+/**
+ * Εγγράφει len bytes της εξόδου WAV στο stdout σε ένα βήμα.
+ */
+void write_bytes_safe(const unsigned char *src, size_t len) {
+    if (output_is_lossless) {
+        for (size_t i = 0; i < len; i++) {
+            lossless_write_byte(src[i]);
+        }
+    } else {
+        fwrite(src, 1, len, stdout);
+    }
+}
+
+/**
+ * Εγγράφει ένα byte της εξόδου WAV στο stdout.
+ * Με την επιλογή --lossless το byte περνάει από τον κωδικοποιητή SWLC.
+ */
+void write_byte_safe(int byte) {
+    if (output_is_lossless) {
+        lossless_write_byte(byte);
+    } else {
+        putchar(byte);
+    }
+}
+
 /**
  * Διαβάζει έναν ακέραιο 4-byte (uint32_t) little-endian.
  */
@@ -98,7 +196,7 @@ int check_tag(const char* expected_tag) {
 void write_tag(const char* tag) {
     int i;
     for (i = 0; i < 4; i++) {
-        putchar(tag[i]);
+        write_byte_safe(tag[i]);
     }
 }
 
@@ -106,10 +204,18 @@ void write_tag(const char* tag) {
  * Εγγράφει έναν ακέραιο 4-byte (uint32_t) στο stdout, little-endian.
  */
 void write_le_uint32(unsigned int value) {
-    putchar(value & 0xFF);         // 1ο byte (LSB)
-    putchar((value >> 8) & 0xFF);
-    putchar((value >> 16) & 0xFF);
-    putchar((value >> 24) & 0xFF); // 4ο byte (MSB)
+    write_byte_safe(value & 0xFF);         // 1ο byte (LSB)
+    write_byte_safe((value >> 8) & 0xFF);
+    write_byte_safe((value >> 16) & 0xFF);
+    write_byte_safe((value >> 24) & 0xFF); // 4ο byte (MSB)
+}
+
+/**
+ * Εγγράφει έναν ακέραιο 2-byte (uint16_t) στο stdout, little-endian.
+ */
+void write_le_uint16(unsigned short value) {
+    write_byte_safe(value & 0xFF);        // 1ο byte (LSB)
+    write_byte_safe((value >> 8) & 0xFF); // 2ο byte (MSB)
 }
 
 /**
@@ -122,6 +228,760 @@ void write_le_int16(short value) {
 }
 
 
+// ------------------------------------------------
+// Συμπιεσμένη μορφή SWLC (Lossless)
+// ------------------------------------------------
+
+/*
+ * Η μορφή SWLC αποθηκεύει χωρίς απώλειες ακριβώς τα bytes που θα έγραφε το
+ * PCM μονοπάτι. Τα δείγματα χωρίζονται σε frames των SWLC_BLOCK_FRAMES
+ * δειγμάτων ανά κανάλι· κάθε frame αποκωδικοποιείται ανεξάρτητα, οπότε η
+ * κωδικοποίηση/αποκωδικοποίηση γίνεται παράλληλα ανά ομάδα frames (OpenMP,
+ * αν μεταγλωττιστεί με -fopenmp· αλλιώς σειριακά, βλ. README.md).
+ *
+ * Διάταξη αρχείου (όλοι οι ακέραιοι little-endian):
+ *
+ *   "SWLC"          (4 bytes)  magic
+ *   Version         (2 bytes)  = 1
+ *   BlockFrames     (4 bytes)  μέγιστα δείγματα ανά κανάλι σε κάθε frame
+ *   PrefixLen       (4 bytes)  μήκος της αρχικής κεφαλίδας WAV (συνήθως 44)
+ *   Prefix          (PrefixLen bytes) η κεφαλίδα WAV αυτούσια
+ *   Frame ...                  ένα ή περισσότερα frames:
+ *     FrameFrames   (4 bytes)  δείγματα ανά κανάλι (0 = τέλος των frames)
+ *     PayloadLen    (4 bytes)
+ *     Payload       (PayloadLen bytes) bitstream (MSB πρώτο), ανά κανάλι:
+ *       Order       (3 bits)   τάξη του σταθερού γραμμικού predictor (0..4),
+ *                                ή 7 = verbatim: ακολουθούν FrameFrames δείγματα
+ *                                αυτούσια (BitsPerSample bits) και τίποτα άλλο
+ *       K           (5 bits)   παράμετρος Rice
+ *       Warmup      Order δείγματα αυτούσια (BitsPerSample bits το καθένα)
+ *       Residuals   υπόλοιπα πρόβλεψης, zigzag + Rice(K). Πηλίκο >= 24
+ *                  γράφεται ως 24 άσσοι ακολουθούμενοι από την τιμή σε 32 bits.
+ *   TailLen         (4 bytes)
+ *   Tail            (TailLen bytes) ό,τι δεν είναι πλήρες δείγμα (π.χ. OtherData)
+ *   SeekCount       (4 bytes)
+ *   SeekTable       (SeekCount x 4 bytes) θέση κάθε frame από την αρχή του αρχείου
+ *   SeekTableOffset (4 bytes)  θέση του SeekCount, για τυχαία πρόσβαση από το τέλος
+ *
+ * Τα offsets είναι 32-bit: ο κωδικοποιητής απορρίπτει έξοδο άνω των 4 GiB. Ο
+ * αποκωδικοποιητής ελέγχει ότι ο πίνακας αναζήτησης συμφωνεί με τα frames.
+ */
+
+#define SWLC_VERSION 1
+#define SWLC_BLOCK_FRAMES 4096  // Δείγματα ανά κανάλι σε κάθε frame
+#define SWLC_BATCH 16           // Frames που επεξεργάζονται παράλληλα
+#define SWLC_MAX_ORDER 4
+#define SWLC_ORDER_VERBATIM 7   // Order για subframe με ακατέργαστα δείγματα
+#define SWLC_MAX_RICE_K 20
+#define SWLC_RICE_ESCAPE 24
+#define SWLC_WAV_HEADER 44
+
+// Buffer bits για εγγραφή (MSB πρώτο).
+typedef struct {
+    unsigned char *data;
+    size_t len;
+    size_t cap;
+    uint64_t acc;
+    int nbits;
+} BitWriter;
+
+// Buffer bits για ανάγνωση (MSB πρώτο).
+typedef struct {
+    const unsigned char *data;
+    size_t len;
+    size_t pos;
+    uint64_t acc;
+    int nbits;
+    int overrun; // 1 αν ζητήθηκαν bits πέρα από το τέλος του payload
+} BitReader;
+
+/**
+ * malloc/realloc που τερματίζει το πρόγραμμα σε αποτυχία.
+ */
+// 1 όσο εκτελείται η lossless_finish() (από την atexit()), όπου δεν
+// επιτρέπεται δεύτερη κλήση της exit().
+static int swlc_finishing = 0;
+
+/**
+ * Τυπώνει μήνυμα σφάλματος και τερματίζει το πρόγραμμα.
+ */
+void swlc_fail(const char *message) {
+    fprintf(stderr, "%s\n", message);
+    if (swlc_finishing) {
+        _Exit(1);
+    }
+    exit(1);
+}
+
+void *swlc_realloc(void *ptr, size_t size) {
+    void *p = realloc(ptr, size ? size : 1);
+    if (p == NULL) {
+        swlc_fail("Error! out of memory");
+    }
+    return p;
+}
+
+void bw_push_byte(BitWriter *bw, unsigned char byte) {
+    if (bw->len == bw->cap) {
+        bw->cap = bw->cap ? bw->cap * 2 : 4096;
+        bw->data = swlc_realloc(bw->data, bw->cap);
+    }
+    bw->data[bw->len++] = byte;
+}
+
+/**
+ * Εγγράφει τα n χαμηλότερα bits του value (n <= 32).
+ */
+void bw_put(BitWriter *bw, uint32_t value, int n) {
+    bw->acc = (bw->acc << n) | ((uint64_t)value & ((1ULL << n) - 1));
+    bw->nbits += n;
+    while (bw->nbits >= 8) {
+        bw->nbits -= 8;
+        bw_push_byte(bw, (unsigned char)(bw->acc >> bw->nbits));
+    }
+    bw->acc &= (1ULL << bw->nbits) - 1;
+}
+
+/**
+ * Συμπληρώνει με μηδενικά το τελευταίο byte.
+ */
+void bw_flush(BitWriter *bw) {
+    if (bw->nbits > 0) {
+        bw_push_byte(bw, (unsigned char)(bw->acc << (8 - bw->nbits)));
+        bw->nbits = 0;
+        bw->acc = 0;
+    }
+}
+
+/**
+ * Διαβάζει n bits (n <= 32). Πέρα από το τέλος επιστρέφει μηδενικά και
+ * ενεργοποιεί τη σημαία overrun.
+ */
+uint32_t br_get(BitReader *br, int n) {
+    while (br->nbits < n) {
+        if (br->pos < br->len) {
+            br->acc = (br->acc << 8) | br->data[br->pos++];
+        } else {
+            br->acc <<= 8;
+            br->overrun = 1;
+        }
+        br->nbits += 8;
+    }
+    br->nbits -= n;
+    uint32_t value = (uint32_t)((br->acc >> br->nbits) & ((1ULL << n) - 1));
+    br->acc &= (1ULL << br->nbits) - 1;
+    return value;
+}
+
+/**
+ * Πρόβλεψη του δείγματος x[i] από τα προηγούμενα με σταθερό πολυωνυμικό
+ * predictor τάξης order (όπως τα "fixed" subframes του FLAC).
+ */
+int64_t swlc_predict(const int *x, unsigned int i, int order) {
+    const int64_t x1 = i >= 1 ? x[i - 1] : 0;
+    const int64_t x2 = i >= 2 ? x[i - 2] : 0;
+    const int64_t x3 = i >= 3 ? x[i - 3] : 0;
+    const int64_t x4 = i >= 4 ? x[i - 4] : 0;
+
+    switch (order) {
+        case 1: return x1;
+        case 2: return 2 * x1 - x2;
+        case 3: return 3 * x1 - 3 * x2 + x3;
+        case 4: return 4 * x1 - 6 * x2 + 4 * x3 - x4;
+        default: return 0;
+    }
+}
+
+/**
+ * Κωδικοποιεί ένα κανάλι n δειγμάτων: επιλογή τάξης και παραμέτρου Rice
+ * που ελαχιστοποιούν το μέγεθος, και εγγραφή του subframe. Αν η πρόβλεψη
+ * δεν κερδίζει τίποτα, γράφεται verbatim subframe (όπως στο FLAC).
+ */
+void swlc_encode_channel(BitWriter *bw, const int *x, unsigned int n, int bits, uint32_t *residuals) {
+    int max_order = n < SWLC_MAX_ORDER ? (int)n : SWLC_MAX_ORDER;
+
+    // Επιλογή τάξης με βάση το άθροισμα απόλυτων υπολοίπων
+    int order = 0;
+    uint64_t best_sum = UINT64_MAX;
+    for (int o = 0; o <= max_order; o++) {
+        uint64_t sum = 0;
+        for (unsigned int i = (unsigned int)max_order; i < n; i++) {
+            int64_t r = x[i] - swlc_predict(x, i, o);
+            sum += (uint64_t)(r < 0 ? -r : r);
+        }
+        if (sum < best_sum) {
+            best_sum = sum;
+            order = o;
+        }
+    }
+
+    // Zigzag: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+    unsigned int count = n - (unsigned int)order;
+    for (unsigned int i = order; i < n; i++) {
+        int r = (int)(x[i] - swlc_predict(x, i, order));
+        residuals[i - order] = ((uint32_t)r << 1) ^ (uint32_t)(r >> 31);
+    }
+
+    // Επιλογή παραμέτρου Rice με ακριβή υπολογισμό του κόστους σε bits
+    int k = 0;
+    uint64_t best_cost = UINT64_MAX;
+    for (int kk = 0; kk <= SWLC_MAX_RICE_K; kk++) {
+        uint64_t cost = 0;
+        for (unsigned int i = 0; i < count; i++) {
+            uint32_t q = residuals[i] >> kk;
+            cost += q < SWLC_RICE_ESCAPE ? q + 1 + kk : SWLC_RICE_ESCAPE + 32;
+        }
+        if (cost < best_cost) {
+            best_cost = cost;
+            k = kk;
+        }
+    }
+
+    // Verbatim αν το Rice subframe δεν είναι μικρότερο από τα ακατέργαστα δείγματα
+    if (5 + (uint64_t)order * bits + best_cost >= (uint64_t)n * bits) {
+        bw_put(bw, SWLC_ORDER_VERBATIM, 3);
+        for (unsigned int i = 0; i < n; i++) {
+            bw_put(bw, (uint32_t)x[i], bits);
+        }
+        return;
+    }
+
+    bw_put(bw, (uint32_t)order, 3);
+    bw_put(bw, (uint32_t)k, 5);
+    for (int i = 0; i < order; i++) {
+        bw_put(bw, (uint32_t)x[i], bits);
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        uint32_t q = residuals[i] >> k;
+        if (q < SWLC_RICE_ESCAPE) {
+            for (uint32_t j = 0; j < q; j++) bw_put(bw, 1, 1);
+            bw_put(bw, 0, 1);
+            bw_put(bw, residuals[i], k);
+        } else {
+            for (int j = 0; j < SWLC_RICE_ESCAPE; j++) bw_put(bw, 1, 1);
+            bw_put(bw, residuals[i], 32);
+        }
+    }
+}
+
+/**
+ * Αποκωδικοποιεί ένα κανάλι n δειγμάτων στο x.
+ * @return 0 σε επιτυχία, -1 αν το payload είναι κατεστραμμένο.
+ */
+int swlc_decode_channel(BitReader *br, int *x, unsigned int n, int bits) {
+    const int64_t min_sample = -(1LL << (bits - 1));
+    const int64_t max_sample = (1LL << (bits - 1)) - 1;
+    int order = (int)br_get(br, 3);
+
+    if (order == SWLC_ORDER_VERBATIM) {
+        for (unsigned int i = 0; i < n; i++) {
+            uint32_t raw = br_get(br, bits);
+            x[i] = (int)(raw ^ (1u << (bits - 1))) - (1 << (bits - 1));
+        }
+        return br->overrun ? -1 : 0;
+    }
+
+    int k = (int)br_get(br, 5);
+    if (order > SWLC_MAX_ORDER || (unsigned int)order > n || k > SWLC_MAX_RICE_K) {
+        return -1;
+    }
+
+    for (int i = 0; i < order; i++) {
+        uint32_t raw = br_get(br, bits);
+        // Επέκταση προσήμου από bits σε int
+        x[i] = (int)(raw ^ (1u << (bits - 1))) - (1 << (bits - 1));
+    }
+    for (unsigned int i = order; i < n; i++) {
+        uint32_t q = 0;
+        while (q < SWLC_RICE_ESCAPE && br_get(br, 1) == 1) {
+            q++;
+        }
+        uint32_t u = q == SWLC_RICE_ESCAPE ? br_get(br, 32) : (q << k) | br_get(br, k);
+        int64_t r = (int64_t)(u >> 1) ^ -(int64_t)(u & 1);
+        int64_t sample = r + swlc_predict(x, i, order);
+        // Δείγμα εκτός εύρους σημαίνει κατεστραμμένη είσοδο
+        if (sample < min_sample || sample > max_sample) {
+            return -1;
+        }
+        x[i] = (int)sample;
+        if (br->overrun) {
+            return -1;
+        }
+    }
+    return br->overrun ? -1 : 0;
+}
+
+/**
+ * Κωδικοποιεί ένα frame από interleaved PCM bytes (8-bit unsigned ή
+ * 16-bit signed little-endian) στο bw.
+ */
+void swlc_encode_frame(BitWriter *bw, const unsigned char *pcm, unsigned int frames, int channels, int bits) {
+    int *x = swlc_realloc(NULL, frames * sizeof(int));
+    uint32_t *residuals = swlc_realloc(NULL, frames * sizeof(uint32_t));
+    int bytes_per_sample = bits / 8;
+
+    for (int c = 0; c < channels; c++) {
+        for (unsigned int i = 0; i < frames; i++) {
+            const unsigned char *p = pcm + ((size_t)i * channels + c) * bytes_per_sample;
+            x[i] = bits == 8 ? (int)p[0] - 128 : (int)(short)(p[0] | (p[1] << 8));
+        }
+        swlc_encode_channel(bw, x, frames, bits, residuals);
+    }
+    bw_flush(bw);
+
+    free(residuals);
+    free(x);
+}
+
+/**
+ * Αποκωδικοποιεί ένα frame σε interleaved PCM bytes.
+ * @return 0 σε επιτυχία, -1 αν το payload είναι κατεστραμμένο.
+ */
+int swlc_decode_frame(const unsigned char *payload, size_t len, unsigned int frames, int channels, int bits, unsigned char *pcm) {
+    BitReader br = { payload, len, 0, 0, 0, 0 };
+    int *x = swlc_realloc(NULL, frames * sizeof(int));
+    int bytes_per_sample = bits / 8;
+    int status = 0;
+
+    for (int c = 0; c < channels && status == 0; c++) {
+        status = swlc_decode_channel(&br, x, frames, bits);
+        for (unsigned int i = 0; i < frames && status == 0; i++) {
+            unsigned char *p = pcm + ((size_t)i * channels + c) * bytes_per_sample;
+            if (bits == 8) {
+                p[0] = (unsigned char)(x[i] + 128);
+            } else {
+                p[0] = (unsigned char)(x[i] & 0xFF);
+                p[1] = (unsigned char)((x[i] >> 8) & 0xFF);
+            }
+        }
+    }
+
+    free(x);
+    return status;
+}
+
+/**
+ * Ελέγχει αν η κεφαλίδα WAV είναι PCM 8/16-bit mono/stereo, ώστε τα
+ * δεδομένα της να κωδικοποιηθούν ως δείγματα.
+ * @return Το μέγεθος της περιοχής δειγμάτων σε bytes (0 αν δεν υποστηρίζεται).
+ */
+unsigned int swlc_parse_prefix(const unsigned char *h, unsigned int len, int *channels, int *bits) {
+    if (len < SWLC_WAV_HEADER || memcmp(h, "RIFF", 4) != 0 || memcmp(h + 8, "WAVEfmt ", 8) != 0 ||
+        memcmp(h + 36, "data", 4) != 0) {
+        return 0;
+    }
+    unsigned int format_chunk = h[16] | (h[17] << 8) | (h[18] << 16) | ((unsigned int)h[19] << 24);
+    unsigned int wave_type = h[20] | (h[21] << 8);
+    unsigned int mono_stereo = h[22] | (h[23] << 8);
+    unsigned int block_align = h[32] | (h[33] << 8);
+    unsigned int bits_per_sample = h[34] | (h[35] << 8);
+    unsigned int size_of_data = h[40] | (h[41] << 8) | (h[42] << 16) | ((unsigned int)h[43] << 24);
+
+    if (format_chunk != 16 || wave_type != 1 || (mono_stereo != 1 && mono_stereo != 2) ||
+        (bits_per_sample != 8 && bits_per_sample != 16) || block_align != bits_per_sample / 8 * mono_stereo) {
+        return 0;
+    }
+    *channels = (int)mono_stereo;
+    *bits = (int)bits_per_sample;
+    return size_of_data - size_of_data % block_align; // Μόνο πλήρη δείγματα
+}
+
+// ************* Κωδικοποιητής (έξοδος) *************
+
+static struct {
+    unsigned char prefix[SWLC_WAV_HEADER];
+    unsigned int prefix_len;
+    int header_written;
+    int channels;
+    int bits;
+    unsigned int block_align;
+    unsigned int data_left;   // Bytes δειγμάτων που απομένουν στην περιοχή data
+    unsigned char *pcm;       // Δείγματα μιας ομάδας SWLC_BATCH frames
+    size_t pcm_len;
+    size_t pcm_cap;
+    unsigned char *tail;
+    size_t tail_len;
+    size_t tail_cap;
+    uint32_t *seek;
+    size_t seek_len;
+    size_t seek_cap;
+    uint64_t out_pos;         // Bytes που έχουν γραφτεί στο stdout
+} swlc_enc;
+
+/**
+ * Η τρέχουσα θέση εξόδου ως offset του πίνακα αναζήτησης. Τα offsets είναι
+ * 32-bit, οπότε έξοδος πάνω από 4 GiB απορρίπτεται αντί να αναδιπλωθεί.
+ */
+uint32_t swlc_offset() {
+    if (swlc_enc.out_pos > UINT32_MAX) {
+        swlc_fail("Error! lossless output exceeds 4 GiB");
+    }
+    return (uint32_t)swlc_enc.out_pos;
+}
+
+void swlc_emit_byte(int byte) {
+    putchar(byte);
+    swlc_enc.out_pos++;
+}
+
+void swlc_emit_u32(uint32_t value) {
+    swlc_emit_byte(value & 0xFF);
+    swlc_emit_byte((value >> 8) & 0xFF);
+    swlc_emit_byte((value >> 16) & 0xFF);
+    swlc_emit_byte((value >> 24) & 0xFF);
+}
+
+void swlc_emit_header() {
+    const char *magic = "SWLC";
+    for (int i = 0; i < 4; i++) swlc_emit_byte(magic[i]);
+    swlc_emit_byte(SWLC_VERSION & 0xFF);
+    swlc_emit_byte((SWLC_VERSION >> 8) & 0xFF);
+    swlc_emit_u32(SWLC_BLOCK_FRAMES);
+    swlc_emit_u32(swlc_enc.prefix_len);
+    for (unsigned int i = 0; i < swlc_enc.prefix_len; i++) swlc_emit_byte(swlc_enc.prefix[i]);
+    swlc_enc.header_written = 1;
+}
+
+/**
+ * Κωδικοποιεί παράλληλα τα πλήρη δείγματα του buffer και γράφει τα frames
+ * με τη σειρά τους.
+ */
+void swlc_encode_batch() {
+    unsigned int total_frames = (unsigned int)(swlc_enc.pcm_len / swlc_enc.block_align);
+    int nblocks = (int)((total_frames + SWLC_BLOCK_FRAMES - 1) / SWLC_BLOCK_FRAMES);
+    BitWriter writers[SWLC_BATCH];
+    memset(writers, 0, sizeof(writers));
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int b = 0; b < nblocks; b++) {
+        unsigned int first = (unsigned int)b * SWLC_BLOCK_FRAMES;
+        unsigned int frames = total_frames - first < SWLC_BLOCK_FRAMES ? total_frames - first : SWLC_BLOCK_FRAMES;
+        swlc_encode_frame(&writers[b], swlc_enc.pcm + (size_t)first * swlc_enc.block_align,
+                          frames, swlc_enc.channels, swlc_enc.bits);
+    }
+
+    for (int b = 0; b < nblocks; b++) {
+        unsigned int first = (unsigned int)b * SWLC_BLOCK_FRAMES;
+        unsigned int frames = total_frames - first < SWLC_BLOCK_FRAMES ? total_frames - first : SWLC_BLOCK_FRAMES;
+        if (swlc_enc.seek_len == swlc_enc.seek_cap) {
+            swlc_enc.seek_cap = swlc_enc.seek_cap ? swlc_enc.seek_cap * 2 : 64;
+            swlc_enc.seek = swlc_realloc(swlc_enc.seek, swlc_enc.seek_cap * sizeof(uint32_t));
+        }
+        swlc_enc.seek[swlc_enc.seek_len++] = swlc_offset();
+        swlc_emit_u32(frames);
+        swlc_emit_u32((uint32_t)writers[b].len);
+        for (size_t i = 0; i < writers[b].len; i++) swlc_emit_byte(writers[b].data[i]);
+        free(writers[b].data);
+    }
+    swlc_enc.pcm_len = 0;
+}
+
+void swlc_tail_push(unsigned char byte) {
+    if (swlc_enc.tail_len == swlc_enc.tail_cap) {
+        swlc_enc.tail_cap = swlc_enc.tail_cap ? swlc_enc.tail_cap * 2 : 4096;
+        swlc_enc.tail = swlc_realloc(swlc_enc.tail, swlc_enc.tail_cap);
+    }
+    swlc_enc.tail[swlc_enc.tail_len++] = byte;
+}
+
+/**
+ * Δέχεται ένα byte της εξόδου WAV: κεφαλίδα, δείγματα ή υπόλοιπα δεδομένα.
+ */
+void lossless_write_byte(int byte) {
+    if (swlc_enc.prefix_len < SWLC_WAV_HEADER) {
+        swlc_enc.prefix[swlc_enc.prefix_len++] = (unsigned char)byte;
+        if (swlc_enc.prefix_len == SWLC_WAV_HEADER) {
+            swlc_enc.data_left = swlc_parse_prefix(swlc_enc.prefix, swlc_enc.prefix_len,
+                                                   &swlc_enc.channels, &swlc_enc.bits);
+            if (swlc_enc.data_left > 0) {
+                swlc_enc.block_align = (unsigned int)(swlc_enc.bits / 8 * swlc_enc.channels);
+                swlc_enc.pcm_cap = (size_t)SWLC_BATCH * SWLC_BLOCK_FRAMES * swlc_enc.block_align;
+                swlc_enc.pcm = swlc_realloc(NULL, swlc_enc.pcm_cap);
+            }
+            swlc_emit_header();
+        }
+        return;
+    }
+
+    if (swlc_enc.data_left > 0) {
+        swlc_enc.pcm[swlc_enc.pcm_len++] = (unsigned char)byte;
+        swlc_enc.data_left--;
+        if (swlc_enc.pcm_len == swlc_enc.pcm_cap) {
+            swlc_encode_batch();
+        }
+        return;
+    }
+
+    swlc_tail_push((unsigned char)byte);
+}
+
+/**
+ * Ολοκληρώνει το αρχείο SWLC: τελευταία frames, Tail και πίνακας αναζήτησης.
+ * Καλείται μέσω atexit(), ώστε και μετά από σφάλμα η μερική έξοδος να είναι
+ * έγκυρο SWLC με τα ίδια bytes που θα έγραφε το PCM μονοπάτι.
+ */
+void lossless_finish() {
+    swlc_finishing = 1;
+    if (swlc_enc.prefix_len == 0) {
+        return; // Καμία έξοδος, όπως και στο PCM μονοπάτι
+    }
+    if (!swlc_enc.header_written) {
+        swlc_emit_header(); // Έξοδος μικρότερη από μια κεφαλίδα WAV
+    }
+
+    // Ένα μισό δείγμα στο τέλος (κομμένη έξοδος) πηγαίνει στο Tail, που
+    // είναι ακόμη άδειο αφού η περιοχή data δεν ολοκληρώθηκε
+    if (swlc_enc.pcm_len > 0) {
+        size_t partial = swlc_enc.pcm_len % swlc_enc.block_align;
+        swlc_enc.pcm_len -= partial;
+        for (size_t i = 0; i < partial; i++) {
+            swlc_tail_push(swlc_enc.pcm[swlc_enc.pcm_len + i]);
+        }
+        if (swlc_enc.pcm_len > 0) {
+            swlc_encode_batch();
+        }
+    }
+
+    swlc_emit_u32(0); // Τέλος των frames
+    swlc_emit_u32((uint32_t)swlc_enc.tail_len);
+    for (size_t i = 0; i < swlc_enc.tail_len; i++) swlc_emit_byte(swlc_enc.tail[i]);
+
+    uint32_t seek_table_offset = swlc_offset();
+    swlc_emit_u32((uint32_t)swlc_enc.seek_len);
+    for (size_t i = 0; i < swlc_enc.seek_len; i++) swlc_emit_u32(swlc_enc.seek[i]);
+    swlc_emit_u32(seek_table_offset);
+    swlc_offset(); // Και το συνολικό μέγεθος πρέπει να χωράει σε 32 bits
+
+    free(swlc_enc.pcm);
+    free(swlc_enc.tail);
+    free(swlc_enc.seek);
+}
+
+// ************* Αποκωδικοποιητής (είσοδος) *************
+
+enum { SWLC_STAGE_FRAMES, SWLC_STAGE_TAIL, SWLC_STAGE_SEEK_TABLE, SWLC_STAGE_DONE };
+
+static struct {
+    int stage;
+    int channels;
+    int bits;
+    unsigned int block_align;
+    unsigned int block_frames;
+    unsigned char *buf;       // Αποκωδικοποιημένα bytes προς ανάγνωση
+    size_t buf_len;
+    size_t buf_pos;
+    size_t buf_cap;
+    uint64_t in_pos;          // Bytes SWLC που έχουν διαβαστεί (μαζί με το magic)
+    uint32_t *seek;           // Θέσεις των frames, για έλεγχο του πίνακα αναζήτησης
+    size_t seek_len;
+    size_t seek_cap;
+} swlc_dec;
+
+uint32_t swlc_read_u32() {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        int byte = read_raw_byte();
+        if (byte == EOF) { fprintf(stderr, "Error! insufficient data\n"); exit(1); }
+        value |= (uint32_t)byte << (8 * i);
+    }
+    swlc_dec.in_pos += 4;
+    return value;
+}
+
+void swlc_read_bytes(unsigned char *dst, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        int byte = read_raw_byte();
+        if (byte == EOF) { fprintf(stderr, "Error! insufficient data\n"); exit(1); }
+        dst[i] = (unsigned char)byte;
+    }
+    swlc_dec.in_pos += len;
+}
+
+void swlc_reserve(size_t len) {
+    if (len > swlc_dec.buf_cap) {
+        swlc_dec.buf_cap = len;
+        swlc_dec.buf = swlc_realloc(swlc_dec.buf, swlc_dec.buf_cap);
+    }
+}
+
+/**
+ * Διαβάζει την κεφαλίδα SWLC (μετά το magic) και ετοιμάζει το Prefix για ανάγνωση.
+ */
+void swlc_open_input() {
+    swlc_dec.in_pos = 4; // Το magic διαβάστηκε στην ανίχνευση
+    unsigned char version[2];
+    swlc_read_bytes(version, 2);
+    if ((version[0] | (version[1] << 8)) != SWLC_VERSION) {
+        fprintf(stderr, "Error! unsupported lossless version\n");
+        exit(1);
+    }
+    swlc_dec.block_frames = swlc_read_u32();
+    uint32_t prefix_len = swlc_read_u32();
+    if (swlc_dec.block_frames == 0 || swlc_dec.block_frames > (1u << 20) || prefix_len > SWLC_WAV_HEADER) {
+        fprintf(stderr, "Error! corrupt lossless header\n");
+        exit(1);
+    }
+
+    swlc_reserve(SWLC_WAV_HEADER);
+    swlc_read_bytes(swlc_dec.buf, prefix_len);
+    swlc_dec.buf_len = prefix_len;
+    swlc_dec.buf_pos = 0;
+    if (swlc_parse_prefix(swlc_dec.buf, prefix_len, &swlc_dec.channels, &swlc_dec.bits) > 0) {
+        swlc_dec.block_align = (unsigned int)(swlc_dec.bits / 8 * swlc_dec.channels);
+    }
+    swlc_dec.stage = SWLC_STAGE_FRAMES;
+}
+
+/**
+ * Διαβάζει έως SWLC_BATCH frames και τα αποκωδικοποιεί παράλληλα στο buffer.
+ */
+void swlc_decode_batch() {
+    unsigned char *payloads[SWLC_BATCH];
+    uint32_t lengths[SWLC_BATCH];
+    uint32_t frames[SWLC_BATCH];
+    size_t offsets[SWLC_BATCH];
+    int statuses[SWLC_BATCH];
+    int nblocks = 0;
+    size_t total = 0;
+
+    while (nblocks < SWLC_BATCH) {
+        uint64_t frame_pos = swlc_dec.in_pos;
+        uint32_t n = swlc_read_u32();
+        if (n == 0) {
+            swlc_dec.stage = SWLC_STAGE_TAIL;
+            break;
+        }
+        uint32_t len = swlc_read_u32();
+        size_t max_len = (size_t)n * swlc_dec.channels * (SWLC_RICE_ESCAPE + 32) / 8 + 64;
+        if (swlc_dec.block_align == 0 || n > swlc_dec.block_frames || len > max_len) {
+            fprintf(stderr, "Error! corrupt lossless frame\n");
+            exit(1);
+        }
+        if (swlc_dec.seek_len == swlc_dec.seek_cap) {
+            swlc_dec.seek_cap = swlc_dec.seek_cap ? swlc_dec.seek_cap * 2 : 64;
+            swlc_dec.seek = swlc_realloc(swlc_dec.seek, swlc_dec.seek_cap * sizeof(uint32_t));
+        }
+        swlc_dec.seek[swlc_dec.seek_len++] = (uint32_t)frame_pos;
+        payloads[nblocks] = swlc_realloc(NULL, len);
+        swlc_read_bytes(payloads[nblocks], len);
+        lengths[nblocks] = len;
+        frames[nblocks] = n;
+        offsets[nblocks] = total;
+        total += (size_t)n * swlc_dec.block_align;
+        nblocks++;
+    }
+
+    swlc_reserve(total);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int b = 0; b < nblocks; b++) {
+        statuses[b] = swlc_decode_frame(payloads[b], lengths[b], frames[b], swlc_dec.channels,
+                                        swlc_dec.bits, swlc_dec.buf + offsets[b]);
+    }
+
+    for (int b = 0; b < nblocks; b++) {
+        free(payloads[b]);
+        if (statuses[b] != 0) {
+            fprintf(stderr, "Error! corrupt lossless frame\n");
+            exit(1);
+        }
+    }
+    swlc_dec.buf_len = total;
+    swlc_dec.buf_pos = 0;
+}
+
+/**
+ * Ελέγχει ότι ο πίνακας αναζήτησης στο τέλος της εισόδου αντιστοιχεί στις
+ * θέσεις των frames που διαβάστηκαν και ότι μετά από αυτόν δεν υπάρχει τίποτα.
+ */
+void swlc_check_seek_table() {
+    uint32_t seek_table_offset = (uint32_t)swlc_dec.in_pos;
+    int valid = swlc_dec.in_pos <= UINT32_MAX && swlc_read_u32() == swlc_dec.seek_len;
+    for (size_t i = 0; valid && i < swlc_dec.seek_len; i++) {
+        valid = swlc_read_u32() == swlc_dec.seek[i];
+    }
+    if (!valid || swlc_read_u32() != seek_table_offset || read_raw_byte() != EOF) {
+        fprintf(stderr, "Error! corrupt lossless seek table\n");
+        exit(1);
+    }
+}
+
+/**
+ * Ανιχνεύει αν η είσοδος είναι σε μορφή SWLC. Αλλιώς τα bytes που
+ * διαβάστηκαν επιστρέφονται πρώτα από την read_byte_safe().
+ */
+void lossless_probe_input() {
+    input_probed = 1;
+    while (probe_len < 4) {
+        int byte = read_raw_byte();
+        if (byte == EOF) break;
+        probe_bytes[probe_len++] = (unsigned char)byte;
+    }
+    if (probe_len == 4 && memcmp(probe_bytes, "SWLC", 4) == 0) {
+        input_is_lossless = 1;
+        swlc_open_input();
+    }
+}
+
+/**
+ * Επαναφέρει τον αποκωδικοποιητή για νέα ανάγνωση της εισόδου από την αρχή.
+ */
+void lossless_reset_input() {
+    free(swlc_dec.buf);
+    free(swlc_dec.seek);
+    memset(&swlc_dec, 0, sizeof(swlc_dec));
+}
+
+/**
+ * Επιστρέφει το επόμενο αποκωδικοποιημένο byte της εισόδου SWLC (ή EOF).
+ */
+int lossless_read_byte() {
+    while (swlc_dec.buf_pos == swlc_dec.buf_len) {
+        if (swlc_dec.stage == SWLC_STAGE_FRAMES) {
+            swlc_decode_batch();
+        } else if (swlc_dec.stage == SWLC_STAGE_TAIL) {
+            uint32_t tail_len = swlc_read_u32();
+            swlc_reserve(tail_len);
+            swlc_read_bytes(swlc_dec.buf, tail_len);
+            swlc_dec.buf_len = tail_len;
+            swlc_dec.buf_pos = 0;
+            swlc_dec.stage = SWLC_STAGE_SEEK_TABLE;
+        } else if (swlc_dec.stage == SWLC_STAGE_SEEK_TABLE) {
+            swlc_check_seek_table();
+            swlc_dec.stage = SWLC_STAGE_DONE;
+        } else {
+            return EOF;
+        }
+    }
+    return swlc_dec.buf[swlc_dec.buf_pos++];
+}
+
+/**
+ * Διαβάζει έως len αποκωδικοποιημένα bytes της εισόδου SWLC στο dst.
+ * @return Πλήθος bytes (λιγότερα από len μόνο στο τέλος της εισόδου).
+ */
+size_t lossless_read_bytes(unsigned char *dst, size_t len) {
+    size_t n = 0;
+    while (n < len) {
+        if (swlc_dec.buf_pos == swlc_dec.buf_len) {
+            // Η lossless_read_byte() ξαναγεμίζει το buffer (ή επιστρέφει EOF)
+            int byte = lossless_read_byte();
+            if (byte == EOF) break;
+            dst[n++] = (unsigned char)byte;
+            continue;
+        }
+        size_t available = swlc_dec.buf_len - swlc_dec.buf_pos;
+        size_t count = available < len - n ? available : len - n;
+        memcpy(dst + n, swlc_dec.buf + swlc_dec.buf_pos, count);
+        swlc_dec.buf_pos += count;
+        n += count;
+    }
+    return n;
+}
+
 // ------------------------------------------------
 // Υποεντολή: info
 // ------------------------------------------------
@@ -345,12 +1205,12 @@ void handle_rate(double fp_rate) {
     for (unsigned int i = 0; i < size_of_data; i++) {
         byte = read_byte_safe();
         if (byte == EOF) { fprintf(stderr, "Error! insufficient data\n"); exit(1); }
-        putchar(byte); 
+        write_byte_safe(byte); 
     }
 
     // Αντιγραφή τυχόν OtherData (μέχρι το EOF)
     while ((byte = read_byte_safe()) != EOF) {
-        putchar(byte);
+        write_byte_safe(byte);
     }
 }
 
@@ -429,7 +1289,7 @@ void handle_channel(const char* channel_arg) {
             byte = read_byte_safe();
             if (byte == EOF) { fprintf(stderr, "Error! insufficient data\n"); exit(1); }
             if (keep_left) {
-                putchar(byte); // Κρατάμε το αριστερό
+                write_byte_safe(byte); // Κρατάμε το αριστερό
             }
         }
         
@@ -438,14 +1298,14 @@ void handle_channel(const char* channel_arg) {
             byte = read_byte_safe();
             if (byte == EOF) { fprintf(stderr, "Error! insufficient data\n"); exit(1); }
             if (!keep_left) {
-                putchar(byte); // Κρατάμε το δεξί
+                write_byte_safe(byte); // Κρατάμε το δεξί
             }
         }
     }
     
     // Αντιγραφή τυχόν OtherData (μέχρι το EOF)
     while ((byte = read_byte_safe()) != EOF) {
-        putchar(byte);
+        write_byte_safe(byte);
     }
 }
 
@@ -453,6 +1313,19 @@ void handle_channel(const char* channel_arg) {
 // Υποεντολή: volume
 // ------------------------------------------------
 
+/**
+ * Εφαρμόζει τον πολλαπλασιαστή έντασης σε ένα signed δείγμα: ακέραιωση
+ * (trunc) και περιορισμός (Clamping) στο [min_value, max_value]. Ο
+ * περιορισμός γίνεται σε double, ώστε η μετατροπή σε int να είναι πάντα
+ * ορισμένη. Κοινή για volume και normalize, ώστε να δίνουν ίδια δείγματα.
+ */
+static inline int scale_sample(int sample, double fp_multiplier, int min_value, int max_value) {
+    double truncated = trunc((double)sample * fp_multiplier);
+    if (truncated > max_value) truncated = max_value;
+    if (truncated < min_value) truncated = min_value;
+    return (int)truncated;
+}
+
 void handle_volume(double fp_multiplier) {
     // ... (Ανάγνωση και Έλεγχοι)
     
@@ -504,32 +1377,18 @@ void handle_volume(double fp_multiplier) {
             // 8-bit: Μετατροπή σε signed (αφαίρεση του 128 offset)
             int centered_sample = byte - 128;
             
-            // Εφαρμογή του πολλαπλασιαστή (έντασης)
-            double new_centered = (double)centered_sample * fp_multiplier;
-            
-            // Ακέραιωση (trunc)
-            int final_sample = (int)trunc(new_centered);
-            
-            // Περιορισμός (Clamping) στο εύρος [-128, 127]
-            if (final_sample > 127) final_sample = 127;
-            if (final_sample < -128) final_sample = -128;
+            // Εφαρμογή του πολλαπλασιαστή (έντασης), trunc και Clamping στο [-128, 127]
+            int final_sample = scale_sample(centered_sample, fp_multiplier, -128, 127);
             
             // Επαναφορά του offset και εγγραφή
-            putchar(final_sample + 128);
+            write_byte_safe(final_sample + 128);
 
         } else if (bits_per_sample == 16) {
             // 16-bit: Διάβασμα ως signed short
             short sample = read_le_int16();
             
-            // Εφαρμογή του πολλαπλασιαστή (έντασης)
-            double new_sample_f = (double)sample * fp_multiplier;
-            
-            // Ακέραιωση (trunc)
-            int final_sample = (int)trunc(new_sample_f);
-            
-            // Περιορισμός (Clamping) στο εύρος [-32768, 32767]
-            if (final_sample > 32767) final_sample = 32767;
-            if (final_sample < -32768) final_sample = -32768;
+            // Εφαρμογή του πολλαπλασιαστή (έντασης), trunc και Clamping στο [-32768, 32767]
+            int final_sample = scale_sample(sample, fp_multiplier, -32768, 32767);
             
             // Εγγραφή του signed 16-bit δείγματος
             write_le_int16((short)final_sample);
@@ -538,8 +1397,214 @@ void handle_volume(double fp_multiplier) {
     
     // Αντιγραφή τυχόν OtherData (μέχρι το EOF)
     while ((byte = read_byte_safe()) != EOF) {
-        putchar(byte);
+        write_byte_safe(byte);
+    }
+}
+
+
+// ------------------------------------------------
+// Υποεντολή: normalize
+// ------------------------------------------------
+
+#define NORMALIZE_CHUNK (1 << 20) // Δείγματα ανά τμήμα και στα δύο περάσματα
+
+// Όριο του προσωρινού αρχείου για είσοδο από pipe: το μέγιστο μέγεθος ενός
+// WAV (SizeOfFile είναι 32-bit, συν 8 bytes για RIFF και SizeOfFile). Και η
+// έξοδος SWLC έχει το ίδιο όριο.
+#define NORMALIZE_SPILL_LIMIT ((1ULL << 32) + 8)
+
+/**
+ * Αντιγράφει μη αναζητήσιμη είσοδο (pipe) σε προσωρινό αρχείο, ώστε να
+ * μπορεί να διαβαστεί δεύτερη φορά. Συμπιεσμένη είσοδος SWLC αντιγράφεται
+ * ως έχει, οπότε το αρχείο μένει μικρό. Το μέγεθος περιορίζεται στο
+ * NORMALIZE_SPILL_LIMIT.
+ */
+void spill_input_to_tmpfile() {
+    FILE *tmp = tmpfile();
+    if (tmp == NULL) { fprintf(stderr, "Error! cannot create temporary file: %s\n", strerror(errno)); exit(1); }
+
+    char buffer[65536];
+    unsigned long long total = 0;
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), stdin)) > 0) {
+        total += n;
+        if (total > NORMALIZE_SPILL_LIMIT) {
+            fprintf(stderr, "Error! piped input to 'normalize' exceeds the %llu-byte limit of a WAVE file\n",
+                    NORMALIZE_SPILL_LIMIT);
+            exit(1);
+        }
+        if (fwrite(buffer, 1, n, tmp) != n) {
+            fprintf(stderr, "Error! cannot write temporary file: %s\n", strerror(errno));
+            exit(1);
+        }
     }
+    if (ferror(stdin)) { fprintf(stderr, "Error! cannot read input: %s\n", strerror(errno)); exit(1); }
+    if (fflush(tmp) != 0) { fprintf(stderr, "Error! cannot write temporary file: %s\n", strerror(errno)); exit(1); }
+    input_stream = tmp;
+}
+
+/**
+ * Επιστρέφει την είσοδο στη θέση start για δεύτερο πέρασμα. Η ανίχνευση
+ * μορφής (WAV/SWLC) και ο μετρητής bytes ξεκινούν από την αρχή.
+ */
+void rewind_input(long start) {
+    if (fseek(input_stream, start, SEEK_SET) != 0) { fprintf(stderr, "Error! cannot rewind input\n"); exit(1); }
+    total_bytes_read = 0;
+    input_probed = 0;
+    input_is_lossless = 0;
+    probe_len = 0;
+    probe_pos = 0;
+    lossless_reset_input();
+}
+
+/**
+ * Κανονικοποίηση σε δύο περάσματα: μέτρηση της κορυφής (ή του RMS) και
+ * εφαρμογή του κέρδους με τη scale_sample() (ίδιο trunc + clamping με τη
+ * volume). Και τα δύο περάσματα διαβάζουν την είσοδο σε τμήματα και τα
+ * επεξεργάζονται παράλληλα.
+ */
+void handle_normalize(double target_dbfs, int use_rms) {
+    // Αν η είσοδος δεν είναι αναζητήσιμη (pipe), τη γράφουμε σε προσωρινό αρχείο
+    long start = ftell(input_stream);
+    if (start < 0 || fseek(input_stream, start, SEEK_SET) != 0) {
+        spill_input_to_tmpfile();
+        start = 0;
+        rewind_input(start);
+    }
+
+    // ************* Ανάγνωση και Έλεγχοι (Όπως στη volume) *************
+
+    if (!check_tag("RIFF")) { fprintf(stderr, "Error! \"RIFF\" not found\n"); exit(1); }
+    unsigned int size_of_file = read_le_uint32();
+    if (size_of_file == 0xFFFFFFFF) { fprintf(stderr, "Error! Insufficient data (expected SizeOfFile)\n"); exit(1); }
+    if (!check_tag("WAVE")) { fprintf(stderr, "Error! \"WAVE\" not found\n"); exit(1); }
+    if (!check_tag("fmt ")) { fprintf(stderr, "Error! \"fmt\" not found\n"); exit(1); }
+
+    unsigned int size_of_format_chunk = read_le_uint32();
+    if (size_of_format_chunk != 16) { fprintf(stderr, "Error! size of format chunk should be 16\n"); exit(1); }
+    unsigned short wave_type_format = read_le_uint16();
+    if (wave_type_format != 1) { fprintf(stderr, "Error! WAVE type format should be 1\n"); exit(1); }
+    unsigned short mono_stereo = read_le_uint16();
+    if (mono_stereo != 1 && mono_stereo != 2) { fprintf(stderr, "Error! mono/stereo should be 1 or 2\n"); exit(1); }
+    unsigned int sample_rate = read_le_uint32();
+    unsigned int bytes_per_sec = read_le_uint32();
+    unsigned short block_align = read_le_uint16();
+    unsigned short bits_per_sample = read_le_uint16();
+    if (bits_per_sample != 8 && bits_per_sample != 16) { fprintf(stderr, "Error! normalize only supports 8-bit or 16-bit samples.\n"); exit(1); }
+
+    if (block_align != (bits_per_sample / 8) * mono_stereo) { fprintf(stderr, "Error! block alignment is incorrect\n"); exit(1); }
+    if (bytes_per_sec != sample_rate * block_align) { fprintf(stderr, "Error! bytes/second is incorrect\n"); exit(1); }
+
+    if (!check_tag("data")) { fprintf(stderr, "Error! \"data\" not found\n"); exit(1); }
+    unsigned int size_of_data = read_le_uint32();
+    if (size_of_data == 0xFFFFFFFF) { fprintf(stderr, "Error! Insufficient data (expected SizeOfData)\n"); exit(1); }
+
+    // ************* 1ο Πέρασμα: Μέτρηση *************
+
+    unsigned int bytes_per_sample = bits_per_sample / 8;
+    unsigned int total_samples = size_of_data / bytes_per_sample;
+    unsigned char *chunk = malloc((size_t)NORMALIZE_CHUNK * bytes_per_sample);
+    if (chunk == NULL) { fprintf(stderr, "Error! out of memory\n"); exit(1); }
+
+    int peak = 0;
+    unsigned long long sum_sq = 0; // Ακέραιο άθροισμα: ίδιο αποτέλεσμα για κάθε πλήθος νημάτων
+
+    for (unsigned int done = 0; done < total_samples; ) {
+        int n = total_samples - done < NORMALIZE_CHUNK ? (int)(total_samples - done) : NORMALIZE_CHUNK;
+        size_t chunk_bytes = (size_t)n * bytes_per_sample;
+        if (read_bytes_safe(chunk, chunk_bytes) != chunk_bytes) {
+            fprintf(stderr, "Error! insufficient data\n");
+            exit(1);
+        }
+
+        // Κορυφή και άθροισμα τετραγώνων του τμήματος (centered/signed δείγματα)
+        int chunk_peak = 0;
+        unsigned long long chunk_sum_sq = 0;
+        if (bits_per_sample == 8) {
+#ifdef _OPENMP
+            #pragma omp parallel for simd reduction(max:chunk_peak) reduction(+:chunk_sum_sq)
+#endif
+            for (int i = 0; i < n; i++) {
+                int sample = chunk[i] - 128;
+                int magnitude = sample < 0 ? -sample : sample;
+                chunk_peak = magnitude > chunk_peak ? magnitude : chunk_peak;
+                chunk_sum_sq += (unsigned long long)(sample * sample);
+            }
+        } else {
+#ifdef _OPENMP
+            #pragma omp parallel for simd reduction(max:chunk_peak) reduction(+:chunk_sum_sq)
+#endif
+            for (int i = 0; i < n; i++) {
+                int sample = (short)(chunk[2 * i] | (chunk[2 * i + 1] << 8));
+                int magnitude = sample < 0 ? -sample : sample;
+                chunk_peak = magnitude > chunk_peak ? magnitude : chunk_peak;
+                chunk_sum_sq += (unsigned long long)((long long)sample * sample);
+            }
+        }
+
+        if (chunk_peak > peak) peak = chunk_peak;
+        sum_sq += chunk_sum_sq;
+        done += (unsigned int)n;
+    }
+
+    // Στάθμη ως κλάσμα της πλήρους κλίμακας (128 για 8-bit, 32768 για 16-bit)
+    double full_scale = bits_per_sample == 8 ? 128.0 : 32768.0;
+    double level = 0.0;
+    if (total_samples > 0) {
+        level = use_rms ? sqrt((double)sum_sq / total_samples) / full_scale : peak / full_scale;
+    }
+    if (level == 0.0) { fprintf(stderr, "Error! cannot normalize silent input\n"); free(chunk); exit(1); }
+
+    // Κέρδος ώστε η στάθμη να γίνει target_dbfs: 10^(target/20) / level
+    double fp_multiplier = pow(10.0, target_dbfs / 20.0) / level;
+    if (!isfinite(fp_multiplier)) { fprintf(stderr, "Error! normalize target is out of range\n"); free(chunk); exit(1); }
+
+    // ************* 2ο Πέρασμα: Εφαρμογή Κέρδους *************
+
+    rewind_input(start);
+
+    // Η κεφαλίδα ελέγχθηκε ήδη και μένει αμετάβλητη, όπως στη volume
+    unsigned char header[44];
+    if (read_bytes_safe(header, sizeof(header)) != sizeof(header)) { fprintf(stderr, "Error! insufficient data\n"); exit(1); }
+    write_bytes_safe(header, sizeof(header));
+
+    for (unsigned int done = 0; done < total_samples; ) {
+        int n = total_samples - done < NORMALIZE_CHUNK ? (int)(total_samples - done) : NORMALIZE_CHUNK;
+        size_t chunk_bytes = (size_t)n * bytes_per_sample;
+        if (read_bytes_safe(chunk, chunk_bytes) != chunk_bytes) {
+            fprintf(stderr, "Error! insufficient data\n");
+            exit(1);
+        }
+
+        if (bits_per_sample == 8) {
+#ifdef _OPENMP
+            #pragma omp parallel for
+#endif
+            for (int i = 0; i < n; i++) {
+                chunk[i] = (unsigned char)(scale_sample(chunk[i] - 128, fp_multiplier, -128, 127) + 128);
+            }
+        } else {
+#ifdef _OPENMP
+            #pragma omp parallel for
+#endif
+            for (int i = 0; i < n; i++) {
+                int sample = (short)(chunk[2 * i] | (chunk[2 * i + 1] << 8));
+                int final_sample = scale_sample(sample, fp_multiplier, -32768, 32767);
+                chunk[2 * i] = (unsigned char)(final_sample & 0xFF);
+                chunk[2 * i + 1] = (unsigned char)((final_sample >> 8) & 0xFF);
+            }
+        }
+
+        write_bytes_safe(chunk, chunk_bytes);
+        done += (unsigned int)n;
+    }
+
+    // Αντιγραφή τυχόν OtherData (μέχρι το EOF)
+    size_t n;
+    while ((n = read_bytes_safe(chunk, (size_t)NORMALIZE_CHUNK * bytes_per_sample)) > 0) {
+        write_bytes_safe(chunk, n);
+    }
+    free(chunk);
 }
 
 
@@ -649,15 +1714,26 @@ int main(int argc, char *argv[]) {
     // Αυτό είναι κρίσιμο για την τήρηση των περιορισμών χρόνου/μνήμης.
     setvbuf(stdin, NULL, _IOFBF, 1024 * 1024 * 8);
     setvbuf(stdout, NULL, _IOFBF, 1024 * 1024 * 8);
+    input_stream = stdin;
+
+    // Προαιρετική επιλογή --lossless πριν την υποεντολή: έξοδος σε μορφή SWLC.
+    // Η είσοδος ανιχνεύεται αυτόματα (WAV ή SWLC) σε όλες τις υποεντολές.
+    if (argc > 1 && strcmp(argv[1], "--lossless") == 0) {
+        output_is_lossless = 1;
+        atexit(lossless_finish); // Τελευταία frames και πίνακας αναζήτησης SWLC, και μετά από σφάλμα
+        argv++;
+        argc--;
+    }
 
     if (argc < 2) {
-        fprintf(stderr, "Error! Missing subcommand (info, rate, channel, volume, generate)\n");
+        fprintf(stderr, "Error! Missing subcommand (info, rate, channel, volume, normalize, generate)\n");
         return 1;
     }
 
     const char *subcommand = argv[1];
 
     if (strcmp(subcommand, "info") == 0) {
+        if (output_is_lossless) { fprintf(stderr, "Error! 'info' does not produce WAVE output for --lossless.\n"); return 1; }
         if (argc != 2) { fprintf(stderr, "Error! 'info' takes no arguments.\n"); return 1; }
         handle_info();
     } else if (strcmp(subcommand, "rate") == 0) {
@@ -672,7 +1748,22 @@ int main(int argc, char *argv[]) {
         if (argc != 3) { fprintf(stderr, "Error! 'volume' requires one floating-point argument.\n"); return 1; }
         double fp_multiplier = strtod(argv[2], NULL);
         if (fp_multiplier < 0) { fprintf(stderr, "Error! Volume multiplier cannot be negative.\n"); return 1; }
+        if (!isfinite(fp_multiplier)) { fprintf(stderr, "Error! Volume multiplier must be finite.\n"); return 1; }
         handle_volume(fp_multiplier);
+    } else if (strcmp(subcommand, "normalize") == 0) {
+        if (argc != 3 && argc != 4) { fprintf(stderr, "Error! 'normalize' requires a target in dBFS and an optional --rms.\n"); return 1; }
+        int use_rms = 0;
+        if (argc == 4) {
+            if (strcmp(argv[3], "--rms") != 0) { fprintf(stderr, "Error! Unknown 'normalize' option: %s\n", argv[3]); return 1; }
+            use_rms = 1;
+        }
+        char *endptr;
+        double target_dbfs = strtod(argv[2], &endptr);
+        if (endptr == argv[2] || *endptr != '\0' || !isfinite(target_dbfs)) {
+            fprintf(stderr, "Error! 'normalize' target must be a finite number in dBFS.\n");
+            return 1;
+        }
+        handle_normalize(target_dbfs, use_rms);
     } else if (strcmp(subcommand, "generate") == 0) {
         // Η generate μπορεί να πάρει έως 6 προαιρετικά ορίσματα (total 8 args)
         if (argc > 8) { fprintf(stderr, "Error! 'generate' takes up to 6 optional arguments.\n"); return 1; }
@@ -0,0 +1,102 @@
+#!/bin/sh
+# Έλεγχος round-trip της μορφής SWLC: η έξοδος με --lossless, αφού
+# αποκωδικοποιηθεί, πρέπει να είναι ίδια byte προς byte με την έξοδο WAV.
+#
+# Χρήση: test/roundtrip.sh [path/to/soundwave]
+# Χωρίς όρισμα μεταγλωττίζει το src/soundwave.c σε προσωρινό κατάλογο.
+
+set -u
+
+here=$(cd "$(dirname "$0")" && pwd)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+if [ $# -ge 1 ]; then
+    sw=$1
+else
+    sw=$work/soundwave
+    ${CC:-cc} -O2 -o "$sw" "$here/../src/soundwave.c" -lm || exit 1
+fi
+
+failures=0
+
+# Εγγραφή ακεραίων little-endian με printf
+le16() {
+    printf "\\$(printf %03o $(($1 & 255)))\\$(printf %03o $(($1 >> 8 & 255)))"
+}
+le32() {
+    le16 $(($1 & 65535))
+    le16 $(($1 >> 16 & 65535))
+}
+
+# make_wav <αρχείο> <mono_stereo> <bits> <δεδομένα> <other_data>
+make_wav() {
+    data_size=$(wc -c < "$4")
+    other_size=$(wc -c < "$5")
+    block_align=$(($3 / 8 * $2))
+    {
+        printf RIFF; le32 $((36 + data_size + other_size))
+        printf 'WAVEfmt '; le32 16; le16 1; le16 "$2"
+        le32 8000; le32 $((8000 * block_align)); le16 $block_align; le16 "$3"
+        printf data; le32 "$data_size"
+        cat "$4" "$5"
+    } > "$1"
+}
+
+# check <όνομα> <είσοδος ή -> <υποεντολή> [ορίσματα...]
+check() {
+    name=$1
+    input=$2
+    shift 2
+    if [ "$input" = - ]; then input=/dev/null; fi
+
+    "$sw" "$@" < "$input" > "$work/expected" 2>/dev/null
+    "$sw" --lossless "$@" < "$input" > "$work/lossless" 2>/dev/null
+    # Η rate 1 αντιγράφει τα bytes αυτούσια, άρα λειτουργεί ως αποκωδικοποιητής
+    "$sw" rate 1 < "$work/lossless" > "$work/decoded" 2>/dev/null
+
+    if cmp -s "$work/expected" "$work/decoded"; then
+        echo "ok   $name"
+    else
+        echo "FAIL $name"
+        failures=$((failures + 1))
+    fi
+}
+
+# Πηγές δεδομένων: ομαλό σήμα (από τη generate) και θόρυβος
+"$sw" generate 1 8000 3 440 2 12000 | tail -c +45 > "$work/smooth"
+head -c 20001 /dev/urandom > "$work/noise"
+printf 'OTHER' > "$work/other"
+: > "$work/none"
+
+head -c 12001 "$work/smooth" > "$work/smooth_odd"
+make_wav "$work/m16.wav" 1 16 "$work/smooth" "$work/none"
+make_wav "$work/s16_odd.wav" 2 16 "$work/smooth_odd" "$work/other"
+make_wav "$work/s16_noise.wav" 2 16 "$work/noise" "$work/other"
+make_wav "$work/m8.wav" 1 8 "$work/smooth_odd" "$work/none"
+make_wav "$work/s8_odd.wav" 2 8 "$work/noise" "$work/other"
+
+check "generate default" - generate
+check "generate short" - generate 1 8000 50 440 1 20000
+check "generate silent" - generate 1 8000 1 1 1 0
+
+for wav in m16 s16_odd s16_noise m8 s8_odd; do
+    check "$wav rate" "$work/$wav.wav" rate 1.5
+    check "$wav volume up" "$work/$wav.wav" volume 3.7
+    check "$wav volume down" "$work/$wav.wav" volume 0.25
+done
+
+for wav in s16_odd s16_noise s8_odd; do
+    check "$wav channel left" "$work/$wav.wav" channel left
+    check "$wav channel right" "$work/$wav.wav" channel right
+done
+
+# Κομμένη είσοδος: και τα δύο μονοπάτια γράφουν την ίδια μερική έξοδο
+head -c 5001 "$work/s16_odd.wav" > "$work/truncated.wav"
+check "truncated channel" "$work/truncated.wav" channel left
+
+if [ $failures -ne 0 ]; then
+    echo "$failures round-trip check(s) failed"
+    exit 1
+fi
+echo "all round-trip checks passed"